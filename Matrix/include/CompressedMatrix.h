@@ -0,0 +1,562 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "Matrix.h"
+
+// Values stored as Storage (float by default), accumulation done in Tp.
+template<typename Tp, typename Storage>
+class MixedCRSMatrix {
+public:
+    using size_type  = std::size_t;
+    using Dimensions = typename CRSMatrix<Tp>::Dimensions;
+
+
+public:
+    MixedCRSMatrix() = default;
+
+    explicit MixedCRSMatrix(const CRSMatrix<Tp>& m)
+        : _dim(m._dim), _nnz(m._nnz) {
+        if (not m.empty()) {
+            _v         = new Storage[_nnz];
+            _col_index = new size_type[_nnz];
+            _row_index = new size_type[ridx_size()];
+            for (size_type i = 0; i < _nnz; i++) _v[i] = static_cast<Storage>(m._v[i]);
+            std::memcpy(_col_index, m._col_index, sizeof(size_type) * _nnz);
+            std::memcpy(_row_index, m._row_index, sizeof(size_type) * (ridx_size()));
+        }
+    }
+
+    MixedCRSMatrix(const MixedCRSMatrix& other)
+        : _dim(other._dim), _nnz(other._nnz) {
+        if (not other.empty()) {
+            _v         = new Storage[_nnz];
+            _col_index = new size_type[_nnz];
+            _row_index = new size_type[ridx_size()];
+            std::memcpy(_v, other._v, sizeof(Storage) * _nnz);
+            std::memcpy(_col_index, other._col_index, sizeof(size_type) * _nnz);
+            std::memcpy(_row_index, other._row_index, sizeof(size_type) * (ridx_size()));
+        }
+    }
+
+    MixedCRSMatrix(MixedCRSMatrix&& other) noexcept
+        : _dim(other._dim),
+          _nnz(other._nnz),
+          _v(other._v),
+          _col_index(other._col_index),
+          _row_index(other._row_index) {
+        other._dim       = Dimensions();
+        other._nnz       = size_type();
+        other._v         = nullptr;
+        other._col_index = nullptr;
+        other._row_index = nullptr;
+    }
+
+    ~MixedCRSMatrix() {
+        delete[] _v;
+        delete[] _col_index;
+        delete[] _row_index;
+    }
+
+    MixedCRSMatrix& operator=(const MixedCRSMatrix& other) {
+        if (this != &other) {
+            MixedCRSMatrix tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    MixedCRSMatrix& operator=(MixedCRSMatrix&& other) noexcept {
+        if (this != &other) {
+            clear();
+            _dim       = other._dim;
+            _nnz       = other._nnz;
+            _v         = other._v;
+            _col_index = other._col_index;
+            _row_index = other._row_index;
+
+            other._dim       = Dimensions();
+            other._nnz       = size_type();
+            other._v         = nullptr;
+            other._col_index = nullptr;
+            other._row_index = nullptr;
+        }
+        return *this;
+    }
+
+    void clear() noexcept {
+        delete[] _v;
+        delete[] _col_index;
+        delete[] _row_index;
+        _dim       = Dimensions();
+        _nnz       = size_type();
+        _v         = nullptr;
+        _col_index = nullptr;
+        _row_index = nullptr;
+    }
+
+    CRSMatrix<Tp> to_crs() const {
+        CRSMatrix<Tp> out;
+        if (not empty()) {
+            out._dim       = _dim;
+            out._nnz       = _nnz;
+            out._v         = new Tp[_nnz];
+            out._col_index = new size_type[_nnz];
+            out._row_index = new size_type[ridx_size()];
+            for (size_type i = 0; i < _nnz; i++) out._v[i] = static_cast<Tp>(_v[i]);
+            std::memcpy(out._col_index, _col_index, sizeof(size_type) * _nnz);
+            std::memcpy(out._row_index, _row_index, sizeof(size_type) * (ridx_size()));
+        }
+        return out;
+    }
+
+    inline bool empty() const noexcept {
+        return _row_index == nullptr;
+    }
+
+    inline Dimensions dim() const noexcept {
+        return _dim;
+    }
+
+    inline size_type rows() const noexcept {
+        return _dim.rows;
+    }
+
+    inline size_type cols() const noexcept {
+        return _dim.cols;
+    }
+
+    inline size_type nnz() const noexcept {
+        return _nnz;
+    }
+
+    // matrix-vector multiplication, y = A * x
+    void spmv(const Tp* x, Tp* y) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp sum {};
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++)
+                sum += static_cast<Tp>(_v[j]) * x[_col_index[j]];
+            y[i] = sum;
+        }
+    }
+
+    // multiplication by a dense matrix (row-major, cols() x k), Y = A * X
+    void multiply(const Tp* x, Tp* y, size_type k) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp* yrow = y + i * k;
+            for (size_type c = 0; c < k; c++) yrow[c] = Tp();
+
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                const Tp val   = static_cast<Tp>(_v[j]);
+                const Tp* xrow = x + _col_index[j] * k;
+                for (size_type c = 0; c < k; c++) yrow[c] += val * xrow[c];
+            }
+        }
+    }
+
+
+protected:
+    inline size_type ridx_size() const noexcept {
+        return _dim.rows + 1;
+    }
+
+
+private:
+    Dimensions _dim       = Dimensions();
+    size_type _nnz        = 0;
+    Storage* _v           = nullptr;
+    size_type* _col_index = nullptr;
+    size_type* _row_index = nullptr;
+};
+
+// Column indices stored as 16-bit deltas from the previous column in the row.
+// Deltas that do not fit are replaced by delta_escape and the absolute column
+// index is taken (in order) from the escape array.
+template<typename Tp>
+class DeltaCRSMatrix {
+public:
+    using size_type  = std::size_t;
+    using delta_type = std::uint16_t;
+    using Dimensions = typename CRSMatrix<Tp>::Dimensions;
+
+    static constexpr delta_type delta_escape = 0xFFFF;
+
+
+public:
+    DeltaCRSMatrix() = default;
+
+    explicit DeltaCRSMatrix(const CRSMatrix<Tp>& m)
+        : _dim(m._dim), _nnz(m._nnz) {
+        if (m.empty())
+            return;
+
+        // wyznaczanie liczby indeksów, które nie mieszczą się w delcie
+        for (size_type i = 0; i < rows(); i++) {
+            size_type prev = 0;
+            for (size_type j = m._row_index[i]; j < m._row_index[i + 1]; j++) {
+                if (m._col_index[j] - prev >= delta_escape)
+                    _nesc++;
+                prev = m._col_index[j];
+            }
+        }
+
+        _v         = new Tp[_nnz];
+        _delta     = new delta_type[_nnz];
+        _escape    = new size_type[_nesc];
+        _row_index = new size_type[ridx_size()];
+        std::memcpy(_v, m._v, sizeof(Tp) * _nnz);
+        std::memcpy(_row_index, m._row_index, sizeof(size_type) * (ridx_size()));
+
+        size_type e = 0;
+        for (size_type i = 0; i < rows(); i++) {
+            size_type prev = 0;
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                size_type d = m._col_index[j] - prev;
+                if (d >= delta_escape) {
+                    _delta[j]    = delta_escape;
+                    _escape[e++] = m._col_index[j];
+                }
+                else {
+                    _delta[j] = static_cast<delta_type>(d);
+                }
+                prev = m._col_index[j];
+            }
+        }
+    }
+
+    DeltaCRSMatrix(const DeltaCRSMatrix& other)
+        : _dim(other._dim), _nnz(other._nnz), _nesc(other._nesc) {
+        if (not other.empty()) {
+            _v         = new Tp[_nnz];
+            _delta     = new delta_type[_nnz];
+            _escape    = new size_type[_nesc];
+            _row_index = new size_type[ridx_size()];
+            std::memcpy(_v, other._v, sizeof(Tp) * _nnz);
+            std::memcpy(_delta, other._delta, sizeof(delta_type) * _nnz);
+            std::memcpy(_escape, other._escape, sizeof(size_type) * _nesc);
+            std::memcpy(_row_index, other._row_index, sizeof(size_type) * (ridx_size()));
+        }
+    }
+
+    DeltaCRSMatrix(DeltaCRSMatrix&& other) noexcept
+        : _dim(other._dim),
+          _nnz(other._nnz),
+          _nesc(other._nesc),
+          _v(other._v),
+          _delta(other._delta),
+          _escape(other._escape),
+          _row_index(other._row_index) {
+        other._dim       = Dimensions();
+        other._nnz       = size_type();
+        other._nesc      = size_type();
+        other._v         = nullptr;
+        other._delta     = nullptr;
+        other._escape    = nullptr;
+        other._row_index = nullptr;
+    }
+
+    ~DeltaCRSMatrix() {
+        delete[] _v;
+        delete[] _delta;
+        delete[] _escape;
+        delete[] _row_index;
+    }
+
+    DeltaCRSMatrix& operator=(const DeltaCRSMatrix& other) {
+        if (this != &other) {
+            DeltaCRSMatrix tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    DeltaCRSMatrix& operator=(DeltaCRSMatrix&& other) noexcept {
+        if (this != &other) {
+            clear();
+            _dim       = other._dim;
+            _nnz       = other._nnz;
+            _nesc      = other._nesc;
+            _v         = other._v;
+            _delta     = other._delta;
+            _escape    = other._escape;
+            _row_index = other._row_index;
+
+            other._dim       = Dimensions();
+            other._nnz       = size_type();
+            other._nesc      = size_type();
+            other._v         = nullptr;
+            other._delta     = nullptr;
+            other._escape    = nullptr;
+            other._row_index = nullptr;
+        }
+        return *this;
+    }
+
+    void clear() noexcept {
+        delete[] _v;
+        delete[] _delta;
+        delete[] _escape;
+        delete[] _row_index;
+        _dim       = Dimensions();
+        _nnz       = size_type();
+        _nesc      = size_type();
+        _v         = nullptr;
+        _delta     = nullptr;
+        _escape    = nullptr;
+        _row_index = nullptr;
+    }
+
+    CRSMatrix<Tp> to_crs() const {
+        CRSMatrix<Tp> out;
+        if (not empty()) {
+            out._dim       = _dim;
+            out._nnz       = _nnz;
+            out._v         = new Tp[_nnz];
+            out._col_index = new size_type[_nnz];
+            out._row_index = new size_type[ridx_size()];
+            std::memcpy(out._v, _v, sizeof(Tp) * _nnz);
+            std::memcpy(out._row_index, _row_index, sizeof(size_type) * (ridx_size()));
+
+            size_type e = 0;
+            for (size_type i = 0; i < rows(); i++) {
+                size_type col = 0;
+                for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                    col               = decode(col, _delta[j], e);
+                    out._col_index[j] = col;
+                }
+            }
+        }
+        return out;
+    }
+
+    inline bool empty() const noexcept {
+        return _row_index == nullptr;
+    }
+
+    inline Dimensions dim() const noexcept {
+        return _dim;
+    }
+
+    inline size_type rows() const noexcept {
+        return _dim.rows;
+    }
+
+    inline size_type cols() const noexcept {
+        return _dim.cols;
+    }
+
+    inline size_type nnz() const noexcept {
+        return _nnz;
+    }
+
+    // matrix-vector multiplication, y = A * x
+    void spmv(const Tp* x, Tp* y) const noexcept {
+        size_type e = 0;
+        for (size_type i = 0; i < rows(); i++) {
+            Tp sum {};
+            size_type col = 0;
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                col = decode(col, _delta[j], e);
+                sum += _v[j] * x[col];
+            }
+            y[i] = sum;
+        }
+    }
+
+    // multiplication by a dense matrix (row-major, cols() x k), Y = A * X
+    void multiply(const Tp* x, Tp* y, size_type k) const noexcept {
+        size_type e = 0;
+        for (size_type i = 0; i < rows(); i++) {
+            Tp* yrow = y + i * k;
+            for (size_type c = 0; c < k; c++) yrow[c] = Tp();
+
+            size_type col = 0;
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                col            = decode(col, _delta[j], e);
+                const Tp* xrow = x + col * k;
+                for (size_type c = 0; c < k; c++) yrow[c] += _v[j] * xrow[c];
+            }
+        }
+    }
+
+
+protected:
+    inline size_type ridx_size() const noexcept {
+        return _dim.rows + 1;
+    }
+
+    // e - pozycja kolejnego indeksu w _escape, przesuwana przy każdym użyciu
+    inline size_type decode(size_type prev, delta_type d, size_type& e) const noexcept {
+        return d == delta_escape ? _escape[e++] : prev + d;
+    }
+
+
+private:
+    Dimensions _dim       = Dimensions();
+    size_type _nnz        = 0;
+    size_type _nesc       = 0;
+    Tp* _v                = nullptr;
+    delta_type* _delta    = nullptr;
+    size_type* _escape    = nullptr;
+    size_type* _row_index = nullptr;
+};
+
+// Structure only, every stored value is implicitly equal to one.
+template<typename Tp>
+class PatternCRSMatrix {
+public:
+    using size_type  = std::size_t;
+    using Dimensions = typename CRSMatrix<Tp>::Dimensions;
+
+
+public:
+    PatternCRSMatrix() = default;
+
+    explicit PatternCRSMatrix(const CRSMatrix<Tp>& m)
+        : _dim(m._dim), _nnz(m._nnz) {
+        if (m.empty())
+            return;
+
+        for (size_type i = 0; i < _nnz; i++)
+            if (m._v[i] != Tp(1))
+                throw std::invalid_argument("All non-zero values of a pattern matrix must be equal to one.");
+
+        _col_index = new size_type[_nnz];
+        _row_index = new size_type[ridx_size()];
+        std::memcpy(_col_index, m._col_index, sizeof(size_type) * _nnz);
+        std::memcpy(_row_index, m._row_index, sizeof(size_type) * (ridx_size()));
+    }
+
+    PatternCRSMatrix(const PatternCRSMatrix& other)
+        : _dim(other._dim), _nnz(other._nnz) {
+        if (not other.empty()) {
+            _col_index = new size_type[_nnz];
+            _row_index = new size_type[ridx_size()];
+            std::memcpy(_col_index, other._col_index, sizeof(size_type) * _nnz);
+            std::memcpy(_row_index, other._row_index, sizeof(size_type) * (ridx_size()));
+        }
+    }
+
+    PatternCRSMatrix(PatternCRSMatrix&& other) noexcept
+        : _dim(other._dim),
+          _nnz(other._nnz),
+          _col_index(other._col_index),
+          _row_index(other._row_index) {
+        other._dim       = Dimensions();
+        other._nnz       = size_type();
+        other._col_index = nullptr;
+        other._row_index = nullptr;
+    }
+
+    ~PatternCRSMatrix() {
+        delete[] _col_index;
+        delete[] _row_index;
+    }
+
+    PatternCRSMatrix& operator=(const PatternCRSMatrix& other) {
+        if (this != &other) {
+            PatternCRSMatrix tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    PatternCRSMatrix& operator=(PatternCRSMatrix&& other) noexcept {
+        if (this != &other) {
+            clear();
+            _dim       = other._dim;
+            _nnz       = other._nnz;
+            _col_index = other._col_index;
+            _row_index = other._row_index;
+
+            other._dim       = Dimensions();
+            other._nnz       = size_type();
+            other._col_index = nullptr;
+            other._row_index = nullptr;
+        }
+        return *this;
+    }
+
+    void clear() noexcept {
+        delete[] _col_index;
+        delete[] _row_index;
+        _dim       = Dimensions();
+        _nnz       = size_type();
+        _col_index = nullptr;
+        _row_index = nullptr;
+    }
+
+    CRSMatrix<Tp> to_crs() const {
+        CRSMatrix<Tp> out;
+        if (not empty()) {
+            out._dim       = _dim;
+            out._nnz       = _nnz;
+            out._v         = new Tp[_nnz];
+            out._col_index = new size_type[_nnz];
+            out._row_index = new size_type[ridx_size()];
+            for (size_type i = 0; i < _nnz; i++) out._v[i] = Tp(1);
+            std::memcpy(out._col_index, _col_index, sizeof(size_type) * _nnz);
+            std::memcpy(out._row_index, _row_index, sizeof(size_type) * (ridx_size()));
+        }
+        return out;
+    }
+
+    inline bool empty() const noexcept {
+        return _row_index == nullptr;
+    }
+
+    inline Dimensions dim() const noexcept {
+        return _dim;
+    }
+
+    inline size_type rows() const noexcept {
+        return _dim.rows;
+    }
+
+    inline size_type cols() const noexcept {
+        return _dim.cols;
+    }
+
+    inline size_type nnz() const noexcept {
+        return _nnz;
+    }
+
+    // matrix-vector multiplication, y = A * x
+    void spmv(const Tp* x, Tp* y) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp sum {};
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) sum += x[_col_index[j]];
+            y[i] = sum;
+        }
+    }
+
+    // multiplication by a dense matrix (row-major, cols() x k), Y = A * X
+    void multiply(const Tp* x, Tp* y, size_type k) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp* yrow = y + i * k;
+            for (size_type c = 0; c < k; c++) yrow[c] = Tp();
+
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                const Tp* xrow = x + _col_index[j] * k;
+                for (size_type c = 0; c < k; c++) yrow[c] += xrow[c];
+            }
+        }
+    }
+
+
+protected:
+    inline size_type ridx_size() const noexcept {
+        return _dim.rows + 1;
+    }
+
+
+private:
+    Dimensions _dim       = Dimensions();
+    size_type _nnz        = 0;
+    size_type* _col_index = nullptr;
+    size_type* _row_index = nullptr;
+};
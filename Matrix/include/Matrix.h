@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cstddef>
 #include <cstring>
 #include <iostream>
@@ -6,8 +8,26 @@
 template<typename Tp, std::size_t Rows, std::size_t Cols>
 using BasicMatrix = Tp[Rows][Cols];
 
+template<typename Tp, typename Storage = float>
+class MixedCRSMatrix;
+
+template<typename Tp>
+class DeltaCRSMatrix;
+
+template<typename Tp>
+class PatternCRSMatrix;
+
 template<typename Tp>
 class CRSMatrix {
+    template<typename, typename>
+    friend class MixedCRSMatrix;
+
+    template<typename>
+    friend class DeltaCRSMatrix;
+
+    template<typename>
+    friend class PatternCRSMatrix;
+
 public:
     using size_type = std::size_t;
 
@@ -174,6 +194,10 @@ public:
         return _dim.cols;
     }
 
+    inline size_type nnz() const noexcept {
+        return _nnz;
+    }
+
     // scalar multiplication
     inline CRSMatrix operator*(Tp val) const {
         CRSMatrix out = *this;
@@ -273,6 +297,29 @@ public:
         return *this;
     }
 
+    // matrix-vector multiplication, y = A * x
+    void spmv(const Tp* x, Tp* y) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp sum {};
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++)
+                sum += _v[j] * x[_col_index[j]];
+            y[i] = sum;
+        }
+    }
+
+    // multiplication by a dense matrix (row-major, cols() x k), Y = A * X
+    void multiply(const Tp* x, Tp* y, size_type k) const noexcept {
+        for (size_type i = 0; i < rows(); i++) {
+            Tp* yrow = y + i * k;
+            for (size_type c = 0; c < k; c++) yrow[c] = Tp();
+
+            for (size_type j = _row_index[i]; j < _row_index[i + 1]; j++) {
+                const Tp* xrow = x + _col_index[j] * k;
+                for (size_type c = 0; c < k; c++) yrow[c] += _v[j] * xrow[c];
+            }
+        }
+    }
+
     // addition
     CRSMatrix operator+(const CRSMatrix& other) const {
         if (dim() != other.dim())
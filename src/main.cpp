@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "CompressedMatrix.h"
 #include "Matrix.h"
 
 int main() {
@@ -55,6 +56,34 @@ int main() {
     (m3 * m4).printm();
 
 
+    std::cout << "\nMnożenie macierz-wektor:\n";
+    double x[4] = { 1, 2, 3, 4 }, y[4];
+    m1.printm();
+
+    m1.spmv(x, y);
+    std::cout << "\nCRS:     ";
+    for (auto val : y) std::cout << val << "\t";
+
+    MixedCRSMatrix<double> m1f(m1);
+    m1f.spmv(x, y);
+    std::cout << "\nfloat:   ";
+    for (auto val : y) std::cout << val << "\t";
+
+    DeltaCRSMatrix<double> m1d(m1);
+    m1d.spmv(x, y);
+    std::cout << "\ndelta:   ";
+    for (auto val : y) std::cout << val << "\t";
+
+    PatternCRSMatrix<int> m4p(m4);
+    int xi[3] = { 1, 2, 3 }, yi[2];
+    m4p.spmv(xi, yi);
+    std::cout << "\npattern: ";
+    for (auto val : yi) std::cout << val << "\t";
+    std::cout << '\n';
+
+    m4p.to_crs().printm();
+
+
     // CRSMatrix<int> matrix1({
     // { 10, 20,  0,  0,  0,  0 },
     // {  0, 30,  0,  4,  0,  0 },